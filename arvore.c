@@ -0,0 +1,560 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arvore.h"
+
+// -------------------------------------------------------
+// Blocos imutáveis compartilhados por vários nós
+// -------------------------------------------------------
+// Toda peça da árvore vem de gerarPecaArvore, então a letra sai da
+// semente e do id: fila e pilha guardam só ids (16 bytes por bloco).
+
+// Célula da lista da fila (da peça mais nova para a mais antiga)
+struct Celula {
+    Celula *prox;
+    int refs;
+    int id;
+};
+
+// Até ARV_TAM_PILHA ids em sequência: a pilha inteira (base -> topo) ou
+// as peças da frente da fila trocadas por 4 e 5 (fim -> frente)
+struct Trecho {
+    int refs;
+    int id[ARV_TAM_PILHA];
+};
+
+static size_t bytesVivos = 0;  // memória de nós, células e trechos ainda referenciados
+
+static void *alocar(size_t bytes) {
+    void *p = malloc(bytes);
+    if (p != NULL) {
+        bytesVivos += bytes;
+    }
+    return p;
+}
+
+static Celula *reterCelula(Celula *c) {
+    if (c != NULL) {
+        c->refs++;
+    }
+    return c;
+}
+
+// A nova célula fica com a referência a prox que o chamador possuía
+// (sem memória, devolve NULL e a referência continua com o chamador).
+static Celula *novaCelula(int id, Celula *prox) {
+    Celula *c = alocar(sizeof(Celula));
+    if (c == NULL) {
+        return NULL;
+    }
+    c->refs = 1;
+    c->id = id;
+    c->prox = prox;
+    return c;
+}
+
+static void soltarCelula(Celula *c) {
+    while (c != NULL && --c->refs == 0) {
+        Celula *prox = c->prox;
+        free(c);
+        bytesVivos -= sizeof(Celula);
+        c = prox;
+    }
+}
+
+static Trecho *reterTrecho(Trecho *t) {
+    if (t != NULL) {
+        t->refs++;
+    }
+    return t;
+}
+
+static Trecho *novoTrecho(const int *ids, int n) {
+    Trecho *t = alocar(sizeof(Trecho));
+    if (t == NULL) {
+        return NULL;
+    }
+    t->refs = 1;
+    for (int i = 0; i < n; i++) {
+        t->id[i] = ids[i];
+    }
+    return t;
+}
+
+static void soltarTrecho(Trecho *t) {
+    if (t != NULL && --t->refs == 0) {
+        free(t);
+        bytesVivos -= sizeof(Trecho);
+    }
+}
+
+// -------------------------------------------------------
+// Geração de peça determinística (mesma sequência em todos os ramos)
+// -------------------------------------------------------
+static char letraDaPeca(uint32_t semente, int id) {
+    static const char tipos[] = {'I', 'O', 'T', 'L'};
+    uint32_t x = semente ^ (0x9E3779B9u * (uint32_t)(id + 1));
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return tipos[x >> 30];
+}
+
+static int gerarPecaArvore(NoEstado *no) {
+    return no->proxId++;
+}
+
+// -------------------------------------------------------
+// Fila persistente
+// -------------------------------------------------------
+// Da frente para o fim: as qtdFrente peças do trecho "frente" e depois
+// as qtdFila - qtdFrente primeiras células da lista "fila". As células
+// seguintes são peças já jogadas ou trocadas, mantidas vivas de qualquer
+// forma pelos ancestrais. Enfileirar aloca uma célula, desenfileirar não
+// aloca nada e trocar as k peças da frente aloca um único trecho.
+//
+// As funções que alocam retornam 0 se faltar memória, sem alterar o nó.
+
+// Com a fila cheia a peça é descartada, como em mestre.c.
+static int enfileirarNo(NoEstado *no, int id) {
+    if (no->qtdFila == ARV_TAM_FILA) {
+        return 1;
+    }
+    Celula *c = novaCelula(id, no->fila);
+    if (c == NULL) {
+        return 0;
+    }
+    no->fila = c;
+    no->qtdFila++;
+    return 1;
+}
+
+static int desenfileirarNo(NoEstado *no, int *id) {
+    if (no->qtdFila == 0) {
+        return 0;
+    }
+    if (no->qtdFrente > 0) {
+        // o trecho guarda a frente no fim: tirar é só encurtar
+        *id = no->frente->id[--no->qtdFrente];
+        if (no->qtdFrente == 0) {
+            soltarTrecho(no->frente);
+            no->frente = NULL;
+        }
+    } else {
+        Celula *c = no->fila;
+        for (int i = 1; i < no->qtdFila; i++) {
+            c = c->prox;
+        }
+        *id = c->id;
+    }
+    no->qtdFila--;
+    return 1;
+}
+
+// ids da fila, da frente para o fim
+static int idsDaFila(const NoEstado *no, int ids[ARV_TAM_FILA]) {
+    int n = 0;
+    for (int i = no->qtdFrente - 1; i >= 0; i--) {
+        ids[n++] = no->frente->id[i];
+    }
+    // a lista começa na peça mais nova: preenche de trás para a frente
+    Celula *c = no->fila;
+    for (int i = no->qtdFila - 1; i >= n; i--) {
+        ids[i] = c->id;
+        c = c->prox;
+    }
+    return no->qtdFila;
+}
+
+// Troca as k peças da frente (k <= qtdFila e k <= ARV_TAM_PILHA) por um
+// trecho novo; as células da lista que ficam atrás dele são ignoradas.
+static int substituirFrente(NoEstado *no, const int *novas, int k) {
+    int ids[ARV_TAM_FILA];
+    idsDaFila(no, ids);
+    int m = (k > no->qtdFrente) ? k : no->qtdFrente;
+
+    int trecho[ARV_TAM_PILHA];
+    for (int i = 0; i < m; i++) {
+        trecho[m - 1 - i] = (i < k) ? novas[i] : ids[i];
+    }
+    Trecho *t = novoTrecho(trecho, m);
+    if (t == NULL) {
+        return 0;
+    }
+    soltarTrecho(no->frente);
+    no->frente = t;
+    no->qtdFrente = (uint8_t)m;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Pilha persistente: um trecho base -> topo
+// -------------------------------------------------------
+// Com no máximo ARV_TAM_PILHA peças, copiar a pilha inteira para um
+// trecho novo custa o mesmo que uma célula; desempilhar não aloca.
+static int empilharNo(NoEstado *no, int id) {
+    int ids[ARV_TAM_PILHA];
+    for (int i = 0; i < no->qtdPilha; i++) {
+        ids[i] = no->pilha->id[i];
+    }
+    ids[no->qtdPilha] = id;
+    Trecho *t = novoTrecho(ids, no->qtdPilha + 1);
+    if (t == NULL) {
+        return 0;
+    }
+    soltarTrecho(no->pilha);
+    no->pilha = t;
+    no->qtdPilha++;
+    return 1;
+}
+
+static void desempilharNo(NoEstado *no, int *id) {
+    *id = no->pilha->id[--no->qtdPilha];
+    if (no->qtdPilha == 0) {
+        soltarTrecho(no->pilha);
+        no->pilha = NULL;
+    }
+}
+
+// ids da pilha, do topo para a base
+static int idsDaPilha(const NoEstado *no, int ids[ARV_TAM_PILHA]) {
+    for (int i = 0; i < no->qtdPilha; i++) {
+        ids[i] = no->pilha->id[no->qtdPilha - 1 - i];
+    }
+    return no->qtdPilha;
+}
+
+// Troca as k peças do topo (novas[0] vira o topo).
+static int substituirTopo(NoEstado *no, const int *novas, int k) {
+    int ids[ARV_TAM_PILHA];
+    for (int i = 0; i < no->qtdPilha; i++) {
+        ids[i] = no->pilha->id[i];
+    }
+    for (int i = 0; i < k; i++) {
+        ids[no->qtdPilha - 1 - i] = novas[i];
+    }
+    Trecho *t = novoTrecho(ids, no->qtdPilha);
+    if (t == NULL) {
+        return 0;
+    }
+    soltarTrecho(no->pilha);
+    no->pilha = t;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Criação de nós
+// -------------------------------------------------------
+NoEstado *criarRaizArvore(uint32_t semente) {
+    NoEstado *no = alocar(sizeof(NoEstado));
+    if (no == NULL) {
+        return NULL;
+    }
+    no->pai = NULL;
+    no->refs = 1;
+    no->acao = 0;
+    no->valida = 1;
+    no->profundidade = 0;
+    no->proxId = 0;
+    no->semente = semente;
+    no->fila = NULL;
+    no->qtdFila = 0;
+    no->frente = NULL;
+    no->qtdFrente = 0;
+    no->pilha = NULL;
+    no->qtdPilha = 0;
+
+    for (int i = 0; i < ARV_TAM_FILA; i++) {
+        if (!enfileirarNo(no, gerarPecaArvore(no))) {
+            liberarNo(no);
+            return NULL;
+        }
+    }
+    return no;
+}
+
+// Filho idêntico ao pai: só o nó é alocado, o resto é compartilhado
+static NoEstado *copiarNo(NoEstado *pai, int acao) {
+    NoEstado *no = alocar(sizeof(NoEstado));
+    if (no == NULL) {
+        return NULL;
+    }
+    *no = *pai;
+    no->pai = pai;
+    no->refs = 1;
+    no->acao = (uint8_t)acao;
+    no->valida = 1;
+    no->profundidade = pai->profundidade + 1;
+    pai->refs++;
+    reterCelula(no->fila);
+    reterTrecho(no->frente);
+    reterTrecho(no->pilha);
+    return no;
+}
+
+// Mesma semântica do main() de mestre.c
+NoEstado *ramificarNo(NoEstado *pai, int acao) {
+    NoEstado *no = copiarNo(pai, acao);
+    if (no == NULL) {
+        return NULL;
+    }
+    int ok = 1;
+    int id;
+
+    switch (acao) {
+        case 1: // Jogar peça da fila
+            desenfileirarNo(no, &id);
+            ok = enfileirarNo(no, gerarPecaArvore(no));
+            break;
+
+        case 2: // Reservar peça (fila -> pilha)
+            if (no->qtdPilha == ARV_TAM_PILHA || !desenfileirarNo(no, &id)) {
+                no->valida = 0;
+                break;
+            }
+            ok = empilharNo(no, id) && enfileirarNo(no, gerarPecaArvore(no));
+            break;
+
+        case 3: // Usar peça reservada (a fila cheia não aceita a nova)
+            if (no->qtdPilha == 0) {
+                no->valida = 0;
+                break;
+            }
+            desempilharNo(no, &id);
+            ok = enfileirarNo(no, gerarPecaArvore(no));
+            break;
+
+        case 4: { // Trocar frente da fila com topo da pilha
+            if (no->qtdFila == 0 || no->qtdPilha == 0) {
+                no->valida = 0;
+                break;
+            }
+            int fila[ARV_TAM_FILA];
+            int daPilha[ARV_TAM_PILHA];
+            idsDaFila(no, fila);
+            idsDaPilha(no, daPilha);
+            ok = substituirFrente(no, daPilha, 1) && substituirTopo(no, fila, 1);
+            break;
+        }
+
+        case 5: { // Troca múltipla: 3 primeiras da fila <-> 3 da pilha
+            if (no->qtdFila < 3 || no->qtdPilha < 3) {
+                no->valida = 0;
+                break;
+            }
+            int fila[ARV_TAM_FILA];
+            int daPilha[ARV_TAM_PILHA];
+            idsDaFila(no, fila);
+            idsDaPilha(no, daPilha);
+            ok = substituirFrente(no, daPilha, 3) && substituirTopo(no, fila, 3);
+            break;
+        }
+
+        default:
+            no->valida = 0;
+    }
+
+    if (!ok) {
+        // solta os blocos já trocados e a referência ao pai
+        liberarNo(no);
+        return NULL;
+    }
+    return no;
+}
+
+void liberarNo(NoEstado *no) {
+    while (no != NULL && --no->refs == 0) {
+        NoEstado *pai = no->pai;
+        soltarCelula(no->fila);
+        soltarTrecho(no->frente);
+        soltarTrecho(no->pilha);
+        free(no);
+        bytesVivos -= sizeof(NoEstado);
+        no = pai;
+    }
+}
+
+// -------------------------------------------------------
+// Leitura e exibição
+// -------------------------------------------------------
+int lerFilaNo(const NoEstado *no, PecaArv saida[ARV_TAM_FILA]) {
+    int ids[ARV_TAM_FILA];
+    int n = idsDaFila(no, ids);
+    for (int i = 0; i < n; i++) {
+        saida[i].nome = letraDaPeca(no->semente, ids[i]);
+        saida[i].id = ids[i];
+    }
+    return n;
+}
+
+int lerPilhaNo(const NoEstado *no, PecaArv saida[ARV_TAM_PILHA]) {
+    int ids[ARV_TAM_PILHA];
+    int n = idsDaPilha(no, ids);
+    for (int i = 0; i < n; i++) {
+        saida[i].nome = letraDaPeca(no->semente, ids[i]);
+        saida[i].id = ids[i];
+    }
+    return n;
+}
+
+void exibirNo(const NoEstado *no) {
+    PecaArv pecas[ARV_TAM_FILA];
+    int n = lerFilaNo(no, pecas);
+
+    printf("Lance %d (acao %d%s)\n", no->profundidade, no->acao,
+           no->valida ? "" : ", invalida");
+    printf("Fila de pecas   : ");
+    for (int i = 0; i < n; i++) {
+        printf("[%c %d] ", pecas[i].nome, pecas[i].id);
+    }
+    printf("\nPilha de reserva: ");
+    n = lerPilhaNo(no, pecas);
+    if (n == 0) {
+        printf("[sem pecas reservadas]");
+    } else {
+        printf("(Topo -> base): ");
+        for (int i = 0; i < n; i++) {
+            printf("[%c %d] ", pecas[i].nome, pecas[i].id);
+        }
+    }
+    printf("\n");
+}
+
+size_t memoriaArvore(void) {
+    return bytesVivos;
+}
+
+// -------------------------------------------------------
+// Benchmark (gcc -O2 -DARVORE_BENCH arvore.c -o arvore_bench)
+// -------------------------------------------------------
+#ifdef ARVORE_BENCH
+#include <time.h>
+
+// Nó equivalente guardando cópias completas de Fila e Pilha (mestre.c)
+typedef struct {
+    void *pai;
+    int refs, acao, valida, profundidade, proxId;
+    PecaArv fila[ARV_TAM_FILA];
+    int inicio, fim, qtd;
+    PecaArv pilha[ARV_TAM_PILHA];
+    int topo;
+} NoCopiaCompleta;
+
+static double agoraSegundos(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// O benchmark não tem como continuar sem memória
+static NoEstado *exigirNo(NoEstado *no) {
+    if (no == NULL) {
+        printf("\n[ERRO] Memoria insuficiente para a arvore de estados.\n");
+        exit(EXIT_FAILURE);
+    }
+    return no;
+}
+
+// Memória por ramo de ramos irmãos com um único lance a partir de pos
+static double bytesPorRamo(NoEstado *pos, int acao, int ramos, NoEstado **folhas,
+                           double *ns) {
+    size_t antes = memoriaArvore();
+    double t0 = agoraSegundos();
+    for (int r = 0; r < ramos; r++) {
+        folhas[r] = exigirNo(ramificarNo(pos, acao));
+    }
+    *ns = (agoraSegundos() - t0) * 1e9 / ramos;
+    double bytes = (double)(memoriaArvore() - antes) / ramos;
+    for (int r = 0; r < ramos; r++) {
+        liberarNo(folhas[r]);
+    }
+    return bytes;
+}
+
+int main(void) {
+    const int ramos = 1000;
+    const int passosPorRamo = 4;
+    NoEstado **folhas = malloc(10 * ramos * sizeof(NoEstado *));
+    if (folhas == NULL) {
+        return 1;
+    }
+
+    printf("===== Benchmark Arvore =====\n");
+    printf("Copia completa: %zu bytes/no (sem contar malloc)\n\n", sizeof(NoCopiaCompleta));
+
+    // 1) irmãos de um lance a partir de posições em cada fase da fila
+    // (0 a 4 jogadas desde a raiz), com a pilha vazia, com a pilha cheia
+    // e com a pilha cheia depois de uma troca múltipla (frente em trecho)
+    static const char *estados[] = {"vazia", "cheia", "trocada"};
+    double soma = 0;
+    double pior = 0;
+    double somaNs = 0;
+    int medidas = 0;
+    int piorAcao = 0;
+    printf("Bytes/ramo por acao (%d ramos irmaos por posicao):\n", ramos);
+    printf("pilha    fase    a1     a2     a3     a4     a5\n");
+    for (int estado = 0; estado < 3; estado++) {
+        for (int fase = 0; fase < ARV_TAM_FILA; fase++) {
+            NoEstado *pos = exigirNo(criarRaizArvore(2024u));
+            int reservas = (estado > 0) ? ARV_TAM_PILHA : 0;
+            int trocas = (estado == 2) ? 1 : 0;
+            for (int i = 0; i < reservas + trocas + fase; i++) {
+                int acao = (i < reservas) ? 2 : (i < reservas + trocas) ? 5 : 1;
+                NoEstado *prox = exigirNo(ramificarNo(pos, acao));
+                liberarNo(pos);  // o filho mantém o pai vivo
+                pos = prox;
+            }
+
+            printf("%-8s %4d", estados[estado], fase);
+            for (int acao = 1; acao <= 5; acao++) {
+                double ns;
+                double b = bytesPorRamo(pos, acao, ramos, folhas, &ns);
+                printf(" %6.1f", b);
+                soma += b;
+                somaNs += ns;
+                medidas++;
+                if (b > pior) {
+                    pior = b;
+                    piorAcao = acao;
+                }
+            }
+            printf("\n");
+            liberarNo(pos);
+        }
+    }
+    printf("media: %.1f bytes/ramo, %.1f ns/ramo; pior caso: %.1f bytes/ramo (acao %d)\n",
+           soma / medidas, somaNs / medidas, pior, piorAcao);
+
+    // 2) ramos mais longos: cada um segue por mais alguns lances aleatórios
+    NoEstado *pos = exigirNo(criarRaizArvore(2024u));
+    size_t antes = memoriaArvore();
+    int total = 10 * ramos;
+    srand(7);
+    double t0 = agoraSegundos();
+    for (int r = 0; r < total; r++) {
+        NoEstado *no = exigirNo(ramificarNo(pos, 1 + r % 5));
+        for (int k = 1; k < passosPorRamo; k++) {
+            NoEstado *prox = exigirNo(ramificarNo(no, 1 + rand() % 5));
+            liberarNo(no);
+            no = prox;
+        }
+        folhas[r] = no;
+    }
+    double dt = agoraSegundos() - t0;
+    size_t usados = memoriaArvore() - antes;
+    long nos = (long)total * passosPorRamo;
+
+    printf("%d ramos de %d lances a partir da raiz: %.1f ns/no, %.1f bytes/no\n",
+           total, passosPorRamo, dt * 1e9 / nos, (double)usados / nos);
+
+    for (int r = 0; r < total; r++) {
+        liberarNo(folhas[r]);
+    }
+    liberarNo(pos);
+    printf("Memoria apos liberar: %zu bytes\n", memoriaArvore());
+    free(folhas);
+    return 0;
+}
+#endif
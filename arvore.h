@@ -0,0 +1,79 @@
+#ifndef ARVORE_H
+#define ARVORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// -------------------------------------------------------
+// Árvore de estados para explorar "e se?" a partir de qualquer lance
+// -------------------------------------------------------
+// Cada nó guarda o estado (fila + pilha do nível Mestre) depois de uma
+// ação aplicada ao nó pai. Fila e pilha são blocos imutáveis de 16
+// bytes com contador de referências: um nó filho só aloca os blocos que
+// mudaram e compartilha o resto com o pai. O fim da fila é uma lista a
+// partir da peça mais nova; a frente trocada por 4 e 5 e a pilha inteira
+// ficam em trechos de até 3 peças.
+//
+// Custo de cada ramo (nó de 56 bytes + blocos, em 64 bits, sem contar o
+// cabeçalho do malloc), igual em qualquer posição:
+//   1                  -> nó + 1 bloco  = 72 bytes
+//   2, 4 e 5           -> nó + 2 blocos = 88 bytes (pior caso)
+//   3 e ação inválida  -> só o nó       = 56 bytes (a fila está sempre
+//                         cheia, então 3 não enfileira peça nova)
+// Guardar cópias completas de Fila e Pilha custaria 112 bytes por nó.
+//
+// As ações usam os códigos do menu de mestre.c (1 a 5). A peça gerada
+// depende só da semente e do id, então todos os ramos recebem a mesma
+// sequência de peças novas e podem ser comparados entre si.
+
+#define ARV_TAM_FILA   5
+#define ARV_TAM_PILHA  3
+
+// Mesmo formato da Peca de mestre.c, com outro nome para os dois
+// poderem ser incluídos juntos
+typedef struct {
+    char nome;  // 'I', 'O', 'T', 'L'
+    int id;     // identificador único
+} PecaArv;
+
+typedef struct Celula Celula;
+typedef struct Trecho Trecho;
+
+typedef struct NoEstado {
+    struct NoEstado *pai;  // NULL na raiz
+    Celula *fila;          // fim da fila: mais nova -> mais antiga
+    Trecho *frente;        // frente da fila trocada por 4 e 5 (qtdFrente peças)
+    Trecho *pilha;         // pilha: base -> topo (qtdPilha peças)
+    int refs;              // dono externo + filhos
+    int profundidade;
+    int proxId;
+    uint32_t semente;
+    // contadores pequenos em 1 byte: o nó é o custo fixo de cada ramo
+    uint8_t acao;          // ação que levou do pai a este nó (0 na raiz)
+    uint8_t valida;        // 0 se a ação foi rejeitada (estado igual ao do pai)
+    uint8_t qtdFila;       // total, incluindo as qtdFrente peças da frente
+    uint8_t qtdFrente;
+    uint8_t qtdPilha;
+} NoEstado;
+
+// Cria a posição inicial (fila cheia, pilha vazia).
+// Retorna NULL se faltar memória.
+NoEstado *criarRaizArvore(uint32_t semente);
+
+// Cria um filho de pai aplicando acao. O nó devolvido pertence ao
+// chamador (libere com liberarNo). Retorna NULL se faltar memória; nesse
+// caso nada fica alocado e pai continua como estava.
+NoEstado *ramificarNo(NoEstado *pai, int acao);
+
+// Solta a referência do chamador; nós e células sem referências são
+// liberados, subindo pelos pais quando for o caso.
+void liberarNo(NoEstado *no);
+
+int lerFilaNo(const NoEstado *no, PecaArv saida[ARV_TAM_FILA]);   // frente -> fim
+int lerPilhaNo(const NoEstado *no, PecaArv saida[ARV_TAM_PILHA]); // topo -> base
+void exibirNo(const NoEstado *no);
+
+// Bytes atualmente alocados por todos os nós e células.
+size_t memoriaArvore(void);
+
+#endif
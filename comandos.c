@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "comandos.h"
+
+// -------------------------------------------------------
+// Buffer de entrada
+// -------------------------------------------------------
+void iniciarLeitor(LeitorComandos *l, FILE *f) {
+    l->f = f;
+    l->pos = 0;
+    l->tam = 0;
+    l->tokenErro[0] = '\0';
+    // blocos de TAM_BUFFER_ENTRADA em vez do BUFSIZ padrão
+    setvbuf(f, NULL, _IOFBF, TAM_BUFFER_ENTRADA);
+}
+
+static int recarregar(LeitorComandos *l) {
+    // com a entrada em buffer completo, o prompt não é descarregado
+    // automaticamente antes da leitura
+    fflush(stdout);
+    // copia do bloco já lido pelo stdio até o fim da linha: no terminal
+    // não espera o buffer encher (fread esperaria) e, ao contrário de
+    // fgets + strlen, a contagem não para num byte NUL no meio da linha
+    size_t n = 0;
+    while (n < sizeof(l->buf)) {
+        int c = getc_unlocked(l->f);
+        if (c == EOF) {
+            break;
+        }
+        l->buf[n++] = (char)c;
+        if (c == '\n') {
+            break;
+        }
+    }
+    l->tam = n;
+    l->pos = 0;
+    return n > 0;
+}
+
+static int proximoChar(LeitorComandos *l) {
+    if (l->pos == l->tam && !recarregar(l)) {
+        return EOF;
+    }
+    return (unsigned char)l->buf[l->pos++];
+}
+
+static int ehSeparador(int c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+// -------------------------------------------------------
+// Tokenizador: NUM ou NUMxNUM
+// -------------------------------------------------------
+// Converte token[0..n) em comando; retorna 0 se o formato for inválido
+// ou a ação estiver fora de 0..MAX_ACAO.
+static int analisarToken(const char *token, int n, Comando *cmd) {
+    int i = 0;
+    int acao = 0;
+    int repeticoes = 1;
+
+    while (i < n && token[i] >= '0' && token[i] <= '9' && acao <= MAX_ACAO) {
+        acao = acao * 10 + (token[i] - '0');
+        i++;
+    }
+    if (i == 0 || acao > MAX_ACAO) {
+        return 0;
+    }
+
+    if (i < n) {
+        if (token[i] != 'x' && token[i] != 'X') {
+            return 0;
+        }
+        int inicio = ++i;
+        repeticoes = 0;
+        while (i < n && token[i] >= '0' && token[i] <= '9' && repeticoes <= MAX_REPETICOES) {
+            repeticoes = repeticoes * 10 + (token[i] - '0');
+            i++;
+        }
+        if (i == inicio || i < n || repeticoes < 1 || repeticoes > MAX_REPETICOES) {
+            return 0;
+        }
+    }
+
+    cmd->acao = acao;
+    cmd->repeticoes = repeticoes;
+    return 1;
+}
+
+int lerComandos(LeitorComandos *l, Comando *cmds, int max) {
+    char token[TAM_TOKEN_ERRO];
+    int qtd = 0;
+    int erro = 0;
+    int leuAlgo = 0;
+    int c = proximoChar(l);
+
+    while (c != EOF && c != '\n') {
+        leuAlgo = 1;
+        if (ehSeparador(c)) {
+            c = proximoChar(l);
+            continue;
+        }
+
+        // token: sequência máxima até separador ou fim de linha
+        int n = 0;
+        int longo = 0;
+        while (c != EOF && c != '\n' && !ehSeparador(c)) {
+            if (n < TAM_TOKEN_ERRO - 1) {
+                // NUL é um caractere inválido como outro qualquer; vira '?'
+                // para aparecer na mensagem de erro
+                token[n++] = (c == '\0') ? '?' : (char)c;
+            } else {
+                longo = 1;
+            }
+            c = proximoChar(l);
+        }
+        if (erro) {
+            continue;  // consome o resto da linha
+        }
+
+        if (qtd == max) {
+            erro = 1;
+            strcpy(l->tokenErro, "(comandos demais na linha)");
+        } else if (longo || !analisarToken(token, n, &cmds[qtd])) {
+            erro = 1;
+            token[n] = '\0';
+            strcpy(l->tokenErro, token);
+        } else {
+            qtd++;
+        }
+    }
+
+    if (erro) {
+        return LEITURA_ERRO;
+    }
+    if (c == EOF && !leuAlgo) {
+        return LEITURA_FIM;
+    }
+    return qtd;
+}
+
+// -------------------------------------------------------
+// Benchmark (gcc -O2 -DCOMANDOS_BENCH comandos.c -o comandos_bench)
+// -------------------------------------------------------
+#ifdef COMANDOS_BENCH
+#include <stdlib.h>
+#include <time.h>
+
+static double agoraSegundos(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    const char *arquivo = "comandos_bench.tmp";
+    const long linhas = 2000000;
+    const char *linha = "1 1 2 4 5 3 1 2\n";  // 8 ações por linha
+    FILE *f = fopen(arquivo, "w");
+    if (f == NULL) {
+        printf("[ERRO] Nao foi possivel criar %s.\n", arquivo);
+        return 1;
+    }
+    for (long i = 0; i < linhas; i++) {
+        fputs(linha, f);
+    }
+    fclose(f);
+
+    // 1) scanf("%d") por ação, como no main() original
+    f = fopen(arquivo, "r");
+    long acoesScanf = 0;
+    long soma = 0;
+    int opcao;
+    double t0 = agoraSegundos();
+    while (fscanf(f, "%d", &opcao) == 1) {
+        soma += opcao;
+        acoesScanf++;
+    }
+    double dtScanf = agoraSegundos() - t0;
+    fclose(f);
+
+    // 2) leitor em blocos + tokenizador
+    f = fopen(arquivo, "r");
+    LeitorComandos *l = malloc(sizeof(LeitorComandos));
+    if (f == NULL || l == NULL) {
+        return 1;
+    }
+    iniciarLeitor(l, f);
+    Comando cmds[MAX_COMANDOS_LINHA];
+    long acoesLeitor = 0;
+    int n;
+    t0 = agoraSegundos();
+    while ((n = lerComandos(l, cmds, MAX_COMANDOS_LINHA)) != LEITURA_FIM) {
+        for (int i = 0; i < n; i++) {
+            soma += cmds[i].acao;
+            acoesLeitor += cmds[i].repeticoes;
+        }
+    }
+    double dtLeitor = agoraSegundos() - t0;
+    fclose(f);
+    remove(arquivo);
+
+    printf("===== Benchmark leitura de comandos =====\n");
+    printf("scanf         : %ld acoes, %.1f M acoes/s\n", acoesScanf, acoesScanf / dtScanf / 1e6);
+    printf("lerComandos   : %ld acoes, %.1f M acoes/s\n", acoesLeitor, acoesLeitor / dtLeitor / 1e6);
+    printf("(checksum %ld)\n", soma);
+
+    free(l);
+    return 0;
+}
+#endif
@@ -0,0 +1,45 @@
+#ifndef COMANDOS_H
+#define COMANDOS_H
+
+#include <stdio.h>
+
+// -------------------------------------------------------
+// Leitura de comandos em lote
+// -------------------------------------------------------
+// Cada linha pode trazer várias ações separadas por espaço ou vírgula,
+// com contagem de repetição opcional: "1 1 2 4 5x3" executa 1, 1, 2, 4
+// e três vezes o 5. A entrada é lida em blocos grandes e analisada por
+// um tokenizador próprio (sem scanf). Uma linha com qualquer token
+// inválido (formato errado ou ação fora de 0..MAX_ACAO) é descartada
+// inteira, sem executar nenhuma ação.
+
+#define TAM_BUFFER_ENTRADA     65536
+#define MAX_COMANDOS_LINHA     256
+#define MAX_ACAO               5     // códigos do menu de mestre.c (0 a 5)
+#define MAX_REPETICOES         1000
+#define TAM_TOKEN_ERRO         32
+
+#define LEITURA_FIM   (-1)  // fim da entrada, nada lido
+#define LEITURA_ERRO  (-2)  // linha descartada; ver l->tokenErro
+
+typedef struct {
+    int acao;        // 0 a MAX_ACAO
+    int repeticoes;  // 1 a MAX_REPETICOES
+} Comando;
+
+typedef struct {
+    FILE *f;
+    size_t pos;
+    size_t tam;
+    char tokenErro[TAM_TOKEN_ERRO];
+    char buf[TAM_BUFFER_ENTRADA];
+} LeitorComandos;
+
+// Deve ser chamada antes de qualquer outra leitura em f.
+void iniciarLeitor(LeitorComandos *l, FILE *f);
+
+// Lê a próxima linha para cmds (até max comandos). Retorna a quantidade
+// de comandos (0 para linha vazia), LEITURA_FIM ou LEITURA_ERRO.
+int lerComandos(LeitorComandos *l, Comando *cmds, int max);
+
+#endif
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include "geometria.h"
+
+// -------------------------------------------------------
+// Rotação em tempo de compilação
+// -------------------------------------------------------
+// Grade 4x4 descrita linha a linha; cada linha é um nibble com a
+// coluna 0 no bit menos significativo.
+#define GRADE(l0, l1, l2, l3)  ((l0) | ((l1) << 4) | ((l2) << 8) | ((l3) << 12))
+
+#define POS(l, c)              ((l) * 4 + (c))
+#define MOVE(m, l, c, nl, nc)  ((((m) >> POS(l, c)) & 1u) << POS(nl, nc))
+
+// Giro horário dentro da caixa 3x3 do canto superior esquerdo:
+// (linha, coluna) -> (coluna, 2 - linha)
+#define GIRA3(m) ( \
+    MOVE(m, 0, 0, 0, 2) | MOVE(m, 0, 1, 1, 2) | MOVE(m, 0, 2, 2, 2) | \
+    MOVE(m, 1, 0, 0, 1) | MOVE(m, 1, 1, 1, 1) | MOVE(m, 1, 2, 2, 1) | \
+    MOVE(m, 2, 0, 0, 0) | MOVE(m, 2, 1, 1, 0) | MOVE(m, 2, 2, 2, 0))
+
+// Giro horário na caixa 4x4 (peça I): (linha, coluna) -> (coluna, 3 - linha)
+#define GIRA4(m) ( \
+    MOVE(m, 0, 0, 0, 3) | MOVE(m, 0, 1, 1, 3) | MOVE(m, 0, 2, 2, 3) | MOVE(m, 0, 3, 3, 3) | \
+    MOVE(m, 1, 0, 0, 2) | MOVE(m, 1, 1, 1, 2) | MOVE(m, 1, 2, 2, 2) | MOVE(m, 1, 3, 3, 2) | \
+    MOVE(m, 2, 0, 0, 1) | MOVE(m, 2, 1, 1, 1) | MOVE(m, 2, 2, 2, 1) | MOVE(m, 2, 3, 3, 1) | \
+    MOVE(m, 3, 0, 0, 0) | MOVE(m, 3, 1, 1, 0) | MOVE(m, 3, 2, 2, 0) | MOVE(m, 3, 3, 3, 0))
+
+#define ROTACOES3(m)  { (m), GIRA3(m), GIRA3(GIRA3(m)), GIRA3(GIRA3(GIRA3(m))) }
+#define ROTACOES4(m)  { (m), GIRA4(m), GIRA4(GIRA4(m)), GIRA4(GIRA4(GIRA4(m))) }
+
+// Formas de nascimento do SRS
+#define BASE_I  GRADE(0x0, 0xF, 0x0, 0x0)   // ....  IIII
+#define BASE_O  GRADE(0x6, 0x6, 0x0, 0x0)   // .OO.  .OO.
+#define BASE_T  GRADE(0x2, 0x7, 0x0, 0x0)   // .T.   TTT
+#define BASE_S  GRADE(0x6, 0x3, 0x0, 0x0)   // .SS   SS.
+#define BASE_Z  GRADE(0x3, 0x6, 0x0, 0x0)   // ZZ.   .ZZ
+#define BASE_J  GRADE(0x1, 0x7, 0x0, 0x0)   // J..   JJJ
+#define BASE_L  GRADE(0x4, 0x7, 0x0, 0x0)   // ..L   LLL
+
+const uint16_t FORMAS[GEO_TIPOS][GEO_ROTACOES] = {
+    ROTACOES4(BASE_I),
+    { BASE_O, BASE_O, BASE_O, BASE_O },  // O não muda ao girar
+    ROTACOES3(BASE_T),
+    ROTACOES3(BASE_S),
+    ROTACOES3(BASE_Z),
+    ROTACOES3(BASE_J),
+    ROTACOES3(BASE_L),
+};
+
+// -------------------------------------------------------
+// Chutes de parede do SRS, [rotação de origem][sentido][teste]
+// -------------------------------------------------------
+#define CHUTES_JLSTZ { \
+    { { {0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2} },    /* 0 -> R */ \
+      { {0, 0}, { 1, 0}, { 1, 1}, {0, -2}, { 1, -2} } },  /* 0 -> L */ \
+    { { {0, 0}, { 1, 0}, { 1, -1}, {0, 2}, { 1, 2} },     /* R -> 2 */ \
+      { {0, 0}, { 1, 0}, { 1, -1}, {0, 2}, { 1, 2} } },   /* R -> 0 */ \
+    { { {0, 0}, { 1, 0}, { 1, 1}, {0, -2}, { 1, -2} },    /* 2 -> L */ \
+      { {0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2} } },  /* 2 -> R */ \
+    { { {0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2} },     /* L -> 0 */ \
+      { {0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2} } },   /* L -> 2 */ \
+}
+
+#define CHUTES_I { \
+    { { {0, 0}, {-2, 0}, { 1, 0}, {-2, -1}, { 1, 2} },    /* 0 -> R */ \
+      { {0, 0}, {-1, 0}, { 2, 0}, {-1, 2}, { 2, -1} } },  /* 0 -> L */ \
+    { { {0, 0}, {-1, 0}, { 2, 0}, {-1, 2}, { 2, -1} },    /* R -> 2 */ \
+      { {0, 0}, { 2, 0}, {-1, 0}, { 2, 1}, {-1, -2} } },  /* R -> 0 */ \
+    { { {0, 0}, { 2, 0}, {-1, 0}, { 2, 1}, {-1, -2} },    /* 2 -> L */ \
+      { {0, 0}, { 1, 0}, {-2, 0}, { 1, -2}, {-2, 1} } },  /* 2 -> R */ \
+    { { {0, 0}, { 1, 0}, {-2, 0}, { 1, -2}, {-2, 1} },    /* L -> 0 */ \
+      { {0, 0}, {-2, 0}, { 1, 0}, {-2, -1}, { 1, 2} } },  /* L -> 2 */ \
+}
+
+#define CHUTES_O { { { {0, 0} }, { {0, 0} } } }  // O nunca precisa de chute
+
+// Uma tabela completa por tipo (560 bytes) evita um índice de classe
+const Chute CHUTES[GEO_TIPOS][GEO_ROTACOES][GEO_SENTIDOS][GEO_CHUTES] = {
+    CHUTES_I,
+    CHUTES_O,
+    CHUTES_JLSTZ,
+    CHUTES_JLSTZ,
+    CHUTES_JLSTZ,
+    CHUTES_JLSTZ,
+    CHUTES_JLSTZ,
+};
+
+// Tipo + 1 por letra (0 = letra desconhecida)
+static const int8_t TIPO_POR_LETRA[128] = {
+    ['I'] = 1, ['O'] = 2, ['T'] = 3, ['S'] = 4, ['Z'] = 5, ['J'] = 6, ['L'] = 7,
+};
+
+// -------------------------------------------------------
+// Consultas
+// -------------------------------------------------------
+int tipoDaPeca(char nome) {
+    unsigned char c = (unsigned char)nome;
+    return (c < 128) ? TIPO_POR_LETRA[c] - 1 : -1;
+}
+
+uint16_t formaDaPeca(char nome, int rotacao) {
+    int tipo = tipoDaPeca(nome);
+    if (tipo < 0) {
+        return 0;
+    }
+    return FORMAS[tipo][rotacao & 3];
+}
+
+const Chute *chutesDaPeca(char nome, int rotacao, int sentido) {
+    int tipo = tipoDaPeca(nome);
+    if (tipo < 0) {
+        return NULL;
+    }
+    return CHUTES[tipo][rotacao & 3][sentido & 1];
+}
+
+void exibirForma(uint16_t forma) {
+    for (int l = 0; l < 4; l++) {
+        for (int c = 0; c < 4; c++) {
+            printf("%c", (forma >> POS(l, c)) & 1u ? '#' : '.');
+        }
+        printf("\n");
+    }
+}
+
+// -------------------------------------------------------
+// Benchmark (gcc -O2 -DGEOMETRIA_BENCH geometria.c -o geometria_bench)
+// -------------------------------------------------------
+#ifdef GEOMETRIA_BENCH
+#include <stdlib.h>
+#include <time.h>
+
+static const uint16_t BASES[GEO_TIPOS] = {
+    BASE_I, BASE_O, BASE_T, BASE_S, BASE_Z, BASE_J, BASE_L
+};
+
+// Versão "na hora": gira a forma base célula a célula
+static uint16_t girarForma(uint16_t m, int n) {
+    uint16_t r = 0;
+    for (int l = 0; l < n; l++) {
+        for (int c = 0; c < n; c++) {
+            if ((m >> POS(l, c)) & 1u) {
+                r |= (uint16_t)(1u << POS(c, n - 1 - l));
+            }
+        }
+    }
+    return r;
+}
+
+static uint16_t formaCalculada(char nome, int rotacao) {
+    int tipo = tipoDaPeca(nome);
+    if (tipo < 0) {
+        return 0;
+    }
+    uint16_t m = BASES[tipo];
+    if (nome == 'O') {
+        return m;
+    }
+    int n = (nome == 'I') ? 4 : 3;
+    for (int i = 0; i < (rotacao & 3); i++) {
+        m = girarForma(m, n);
+    }
+    return m;
+}
+
+static double agoraSegundos(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    const char letras[GEO_TIPOS] = {'I', 'O', 'T', 'S', 'Z', 'J', 'L'};
+    const int consultas = 1 << 16;
+    const int voltas = 500;
+
+    // as tabelas do compilador devem bater com o cálculo célula a célula
+    for (int t = 0; t < GEO_TIPOS; t++) {
+        for (int r = 0; r < GEO_ROTACOES; r++) {
+            if (formaDaPeca(letras[t], r) != formaCalculada(letras[t], r)) {
+                printf("[ERRO] Forma divergente: %c rotacao %d\n", letras[t], r);
+                return 1;
+            }
+        }
+    }
+    printf("Peca T, rotacoes 0..3:\n");
+    for (int r = 0; r < GEO_ROTACOES; r++) {
+        exibirForma(formaDaPeca('T', r));
+        printf("\n");
+    }
+
+    char *nomes = malloc(consultas);
+    unsigned char *rots = malloc(consultas);
+    if (nomes == NULL || rots == NULL) {
+        return 1;
+    }
+    srand(1);
+    for (int i = 0; i < consultas; i++) {
+        nomes[i] = letras[rand() % GEO_TIPOS];
+        rots[i] = (unsigned char)(rand() % GEO_ROTACOES);
+    }
+
+    unsigned soma = 0;
+    double t0 = agoraSegundos();
+    for (int v = 0; v < voltas; v++) {
+        for (int i = 0; i < consultas; i++) {
+            soma += formaDaPeca(nomes[i], rots[i] + v);
+            soma += (unsigned)chutesDaPeca(nomes[i], rots[i] + v, v)[1].dx;
+        }
+    }
+    double dtTabela = agoraSegundos() - t0;
+
+    t0 = agoraSegundos();
+    for (int v = 0; v < voltas; v++) {
+        for (int i = 0; i < consultas; i++) {
+            soma += formaCalculada(nomes[i], rots[i] + v);
+        }
+    }
+    double dtCalculo = agoraSegundos() - t0;
+
+    double total = (double)consultas * voltas;
+    printf("===== Benchmark geometria =====\n");
+    printf("tabela (forma + chute): %.1f M rotacoes/s\n", total / dtTabela / 1e6);
+    printf("calculo na hora       : %.1f M rotacoes/s\n", total / dtCalculo / 1e6);
+    printf("(checksum %u)\n", soma);
+
+    free(rots);
+    free(nomes);
+    return 0;
+}
+#endif
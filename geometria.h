@@ -0,0 +1,45 @@
+#ifndef GEOMETRIA_H
+#define GEOMETRIA_H
+
+#include <stdint.h>
+
+// -------------------------------------------------------
+// Geometria das peças: formas e chutes de parede (SRS)
+// -------------------------------------------------------
+// As sete peças ('I', 'O', 'T', 'S', 'Z', 'J', 'L') têm quatro rotações
+// cada, guardadas como máscaras de 16 bits de uma grade 4x4: o bit
+// (linha * 4 + coluna) indica célula ocupada, linha 0 no alto.
+// As rotações e os chutes ficam em tabelas constantes calculadas pelo
+// compilador, então cada consulta é uma única leitura indexada.
+//
+// Rotação: 0 = nascimento, 1 = direita (R), 2 = invertida, 3 = esquerda (L).
+// Sentido: 0 = horário (r -> r+1), 1 = anti-horário (r -> r-1).
+// Chutes: 5 deslocamentos (dx para a direita, dy para cima) testados em
+// ordem até a peça caber, como no SRS.
+
+#define GEO_TIPOS      7
+#define GEO_ROTACOES   4
+#define GEO_SENTIDOS   2
+#define GEO_CHUTES     5
+
+typedef struct {
+    int8_t dx;
+    int8_t dy;
+} Chute;
+
+extern const uint16_t FORMAS[GEO_TIPOS][GEO_ROTACOES];
+extern const Chute CHUTES[GEO_TIPOS][GEO_ROTACOES][GEO_SENTIDOS][GEO_CHUTES];
+
+// Índice em FORMAS/CHUTES para a letra da peça; -1 se desconhecida.
+int tipoDaPeca(char nome);
+
+// Forma da peça (ex.: formaDaPeca(p.nome, rotacao)); 0 se desconhecida.
+uint16_t formaDaPeca(char nome, int rotacao);
+
+// Os GEO_CHUTES deslocamentos para girar a partir de rotacao no sentido
+// dado; NULL se a peça for desconhecida.
+const Chute *chutesDaPeca(char nome, int rotacao, int sentido);
+
+void exibirForma(uint16_t forma);
+
+#endif
@@ -0,0 +1,358 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "historico.h"
+
+#define MASCARA_PARES 0x5555555555555555ull  // bit baixo de cada par de bits
+
+// -------------------------------------------------------
+// Conversão entre letra e código de 2 bits
+// -------------------------------------------------------
+static int codigoDoTipo(char nome) {
+    switch (nome) {
+        case 'I': return 0;
+        case 'O': return 1;
+        case 'T': return 2;
+        case 'L': return 3;
+        default:  return -1;
+    }
+}
+
+// Um bit (na posição baixa de cada par) para cada peça da palavra igual a c
+static uint64_t casamentos(uint64_t palavra, int c) {
+    uint64_t x = palavra ^ (MASCARA_PARES * (uint64_t)c);
+    return ~(x | (x >> 1)) & MASCARA_PARES;
+}
+
+// Ocorrências de c nas primeiras n peças da palavra (0 <= n < 32)
+static size_t contarNaPalavra(uint64_t palavra, int c, size_t n) {
+    uint64_t m = casamentos(palavra, c) & ((1ull << (2 * n)) - 1);
+    return (size_t)__builtin_popcountll(m);
+}
+
+// -------------------------------------------------------
+// Inicialização / liberação
+// -------------------------------------------------------
+void inicializarHistorico(Historico *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+void liberarHistorico(Historico *h) {
+    free(h->palavras);
+    free(h->superblocos);
+    free(h->blocos);
+    for (int t = 0; t < HIST_TIPOS; t++) {
+        free(h->amostras[t]);
+        free(h->esparsos[t]);
+        free(h->posicoes[t]);
+    }
+    inicializarHistorico(h);
+}
+
+// Dobra a capacidade das palavras e dos índices (crescimento amortizado)
+static int crescerHistorico(Historico *h) {
+    size_t novaCap = h->capacidade ? 2 * h->capacidade : 4096;
+    size_t nPalavras = novaCap / HIST_PECAS_PALAVRA;
+    size_t nBlocos = novaCap / HIST_PECAS_BLOCO;
+    size_t nSuper = (novaCap + HIST_PECAS_SUPER - 1) / HIST_PECAS_SUPER;
+
+    uint64_t *palavras = realloc(h->palavras, nPalavras * sizeof(uint64_t));
+    if (palavras == NULL) {
+        return 0;
+    }
+    h->palavras = palavras;
+
+    uint16_t *blocos = realloc(h->blocos, nBlocos * HIST_TIPOS * sizeof(uint16_t));
+    if (blocos == NULL) {
+        return 0;
+    }
+    h->blocos = blocos;
+
+    uint32_t *superblocos = realloc(h->superblocos, nSuper * HIST_TIPOS * sizeof(uint32_t));
+    if (superblocos == NULL) {
+        return 0;
+    }
+    h->superblocos = superblocos;
+
+    h->capacidade = novaCap;
+    return 1;
+}
+
+static int anotarAmostra(Historico *h, int c, uint32_t bloco) {
+    size_t idx = h->total[c] / HIST_PASSO_AMOSTRA;
+    if (idx >= h->capAmostras[c]) {
+        size_t novaCap = h->capAmostras[c] ? 2 * h->capAmostras[c] : 64;
+        uint32_t *a = realloc(h->amostras[c], novaCap * sizeof(uint32_t));
+        if (a == NULL) {
+            return 0;
+        }
+        h->amostras[c] = a;
+        int32_t *e = realloc(h->esparsos[c], novaCap * sizeof(int32_t));
+        if (e == NULL) {
+            return 0;
+        }
+        h->esparsos[c] = e;
+        h->capAmostras[c] = novaCap;
+    }
+    h->amostras[c][idx] = bloco;
+    h->esparsos[c][idx] = -1;
+    return 1;
+}
+
+// Fecha o trecho atual de c (completo com a ocorrência na posição k):
+// se ele se espalha por mais de HIST_SPAN_DENSO lances, guarda as posições.
+static int fecharTrecho(Historico *h, int c, size_t k) {
+    size_t idx = h->total[c] / HIST_PASSO_AMOSTRA;
+    if (k - h->spanAtual[c][0] < HIST_SPAN_DENSO) {
+        return 1;
+    }
+    if (h->qtdPosicoes[c] == h->capPosicoes[c]) {
+        size_t novaCap = h->capPosicoes[c] ? 2 * h->capPosicoes[c] : 4 * HIST_PASSO_AMOSTRA;
+        uint32_t *p = realloc(h->posicoes[c], novaCap * sizeof(uint32_t));
+        if (p == NULL) {
+            return 0;
+        }
+        h->posicoes[c] = p;
+        h->capPosicoes[c] = novaCap;
+    }
+    uint32_t *destino = h->posicoes[c] + h->qtdPosicoes[c];
+    memcpy(destino, h->spanAtual[c], (HIST_PASSO_AMOSTRA - 1) * sizeof(uint32_t));
+    destino[HIST_PASSO_AMOSTRA - 1] = (uint32_t)k;
+    h->esparsos[c][idx] = (int32_t)(h->qtdPosicoes[c] / HIST_PASSO_AMOSTRA);
+    h->qtdPosicoes[c] += HIST_PASSO_AMOSTRA;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Registro de uma jogada
+// -------------------------------------------------------
+int registrarJogada(Historico *h, char nome) {
+    int c = codigoDoTipo(nome);
+    if (c < 0) {
+        return 0;
+    }
+    if (h->qtd == h->capacidade && !crescerHistorico(h)) {
+        return 0;
+    }
+
+    size_t k = h->qtd;
+    size_t bloco = k / HIST_PECAS_BLOCO;
+
+    // início de superbloco / bloco: grava as contagens acumuladas
+    if (k % HIST_PECAS_SUPER == 0) {
+        for (int t = 0; t < HIST_TIPOS; t++) {
+            h->superblocos[(k / HIST_PECAS_SUPER) * HIST_TIPOS + t] = (uint32_t)h->total[t];
+            h->noSuper[t] = 0;
+        }
+    }
+    if (k % HIST_PECAS_BLOCO == 0) {
+        for (int t = 0; t < HIST_TIPOS; t++) {
+            h->blocos[bloco * HIST_TIPOS + t] = (uint16_t)h->noSuper[t];
+        }
+    }
+    if (h->total[c] % HIST_PASSO_AMOSTRA == 0 && !anotarAmostra(h, c, (uint32_t)bloco)) {
+        return 0;
+    }
+    if (h->total[c] % HIST_PASSO_AMOSTRA == HIST_PASSO_AMOSTRA - 1 && !fecharTrecho(h, c, k)) {
+        return 0;
+    }
+    h->spanAtual[c][h->total[c] % HIST_PASSO_AMOSTRA] = (uint32_t)k;
+
+    size_t w = k / HIST_PECAS_PALAVRA;
+    size_t desl = 2 * (k % HIST_PECAS_PALAVRA);
+    if (desl == 0) {
+        h->palavras[w] = 0;
+    }
+    h->palavras[w] |= (uint64_t)c << desl;
+
+    h->total[c]++;
+    h->noSuper[c]++;
+    h->qtd++;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Consultas
+// -------------------------------------------------------
+char pecaNoHistorico(const Historico *h, size_t k) {
+    static const char nomes[HIST_TIPOS] = {'I', 'O', 'T', 'L'};
+    if (k >= h->qtd) {
+        return '\0';
+    }
+    uint64_t w = h->palavras[k / HIST_PECAS_PALAVRA];
+    return nomes[(w >> (2 * (k % HIST_PECAS_PALAVRA))) & 3];
+}
+
+// Ocorrências de c antes do início do bloco b (b deve estar registrado)
+static size_t rankNoBloco(const Historico *h, int c, size_t b) {
+    size_t s = (b * HIST_PECAS_BLOCO) / HIST_PECAS_SUPER;
+    return h->superblocos[s * HIST_TIPOS + c] + h->blocos[b * HIST_TIPOS + c];
+}
+
+// O(1): superbloco + bloco + no máximo 4 popcounts
+size_t rankHistorico(const Historico *h, char nome, size_t k) {
+    int c = codigoDoTipo(nome);
+    if (c < 0) {
+        return 0;
+    }
+    if (k >= h->qtd) {
+        return h->total[c];
+    }
+
+    size_t b = k / HIST_PECAS_BLOCO;
+    size_t r = rankNoBloco(h, c, b);
+    size_t wFim = k / HIST_PECAS_PALAVRA;
+    for (size_t w = b * HIST_PALAVRAS_BLOCO; w < wFim; w++) {
+        r += (size_t)__builtin_popcountll(casamentos(h->palavras[w], c));
+    }
+    return r + contarNaPalavra(h->palavras[wFim], c, k % HIST_PECAS_PALAVRA);
+}
+
+// O(1): trecho incompleto ou esparso é uma leitura direta; trecho denso
+// é uma busca binária em no máximo 64 blocos mais até 4 palavras.
+long selectHistorico(const Historico *h, char nome, size_t j) {
+    int c = codigoDoTipo(nome);
+    if (c < 0 || j >= h->total[c]) {
+        return -1;
+    }
+
+    size_t a = j / HIST_PASSO_AMOSTRA;
+    size_t r = j % HIST_PASSO_AMOSTRA;
+    if (a == h->total[c] / HIST_PASSO_AMOSTRA) {
+        return (long)h->spanAtual[c][r];
+    }
+    if (h->esparsos[c][a] >= 0) {
+        return (long)h->posicoes[c][(size_t)h->esparsos[c][a] * HIST_PASSO_AMOSTRA + r];
+    }
+
+    size_t nBlocos = (h->qtd + HIST_PECAS_BLOCO - 1) / HIST_PECAS_BLOCO;
+    size_t lo = h->amostras[c][a];
+    size_t hi = lo + HIST_SPAN_DENSO / HIST_PECAS_BLOCO;
+    if (hi > nBlocos - 1) {
+        hi = nBlocos - 1;
+    }
+    if ((a + 1) * HIST_PASSO_AMOSTRA < h->total[c] && h->amostras[c][a + 1] < hi) {
+        hi = h->amostras[c][a + 1];
+    }
+
+    // último bloco lo cujo rank inicial é <= j
+    while (lo < hi) {
+        size_t meio = lo + (hi - lo + 1) / 2;
+        if (rankNoBloco(h, c, meio) <= j) {
+            lo = meio;
+        } else {
+            hi = meio - 1;
+        }
+    }
+
+    size_t falta = j - rankNoBloco(h, c, lo);
+    for (size_t w = lo * HIST_PALAVRAS_BLOCO; ; w++) {
+        uint64_t m = casamentos(h->palavras[w], c);
+        if (w == (h->qtd - 1) / HIST_PECAS_PALAVRA && h->qtd % HIST_PECAS_PALAVRA) {
+            m &= (1ull << (2 * (h->qtd % HIST_PECAS_PALAVRA))) - 1;
+        }
+        size_t n = (size_t)__builtin_popcountll(m);
+        if (falta < n) {
+            for (size_t i = 0; i < falta; i++) {
+                m &= m - 1;  // descarta o bit mais baixo
+            }
+            return (long)(w * HIST_PECAS_PALAVRA + (size_t)__builtin_ctzll(m) / 2);
+        }
+        falta -= n;
+    }
+}
+
+size_t memoriaHistorico(const Historico *h) {
+    size_t bytes = h->capacidade / HIST_PECAS_PALAVRA * sizeof(uint64_t)
+                 + h->capacidade / HIST_PECAS_BLOCO * HIST_TIPOS * sizeof(uint16_t)
+                 + (h->capacidade + HIST_PECAS_SUPER - 1) / HIST_PECAS_SUPER
+                   * HIST_TIPOS * sizeof(uint32_t);
+    bytes += sizeof(h->spanAtual);
+    for (int t = 0; t < HIST_TIPOS; t++) {
+        bytes += h->capAmostras[t] * (sizeof(uint32_t) + sizeof(int32_t));
+        bytes += h->capPosicoes[t] * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+// -------------------------------------------------------
+// Benchmark (gcc -O2 -march=native -DHISTORICO_BENCH historico.c -o historico_bench)
+// -------------------------------------------------------
+#ifdef HISTORICO_BENCH
+#include <time.h>
+
+static double agoraSegundos(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// Preenche h com lances peças; 'L' aparece com frequência 1/raridadeL
+// e os outros três tipos dividem o resto igualmente.
+static int preencher(Historico *h, size_t lances, int raridadeL) {
+    const char comuns[] = {'I', 'O', 'T'};
+    inicializarHistorico(h);
+    for (size_t k = 0; k < lances; k++) {
+        char t = (rand() % raridadeL == 0) ? 'L' : comuns[rand() % 3];
+        if (!registrarJogada(h, t)) {
+            printf("[ERRO] Sem memoria.\n");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void medir(const Historico *h, const char *tipos, int nTipos, size_t *ks, int consultas) {
+    size_t soma = 0;
+    double t0 = agoraSegundos();
+    for (int i = 0; i < consultas; i++) {
+        soma += rankHistorico(h, tipos[i % nTipos], ks[i] % h->qtd);
+    }
+    double dtRank = agoraSegundos() - t0;
+
+    t0 = agoraSegundos();
+    for (int i = 0; i < consultas; i++) {
+        char t = tipos[i % nTipos];
+        soma += (size_t)selectHistorico(h, t, ks[i] % h->total[codigoDoTipo(t)]);
+    }
+    double dtSelect = agoraSegundos() - t0;
+
+    printf("  tipos %.*s: rank %.1f ns, select %.1f ns (checksum %zu)\n",
+           nTipos, tipos, dtRank * 1e9 / consultas, dtSelect * 1e9 / consultas, soma);
+}
+
+int main(void) {
+    const int consultas = 10000000;
+    const size_t tamanhos[] = {1000000, 16000000};
+    const int raridades[] = {4, 20000};  // 1/4: uniforme; 1/20000: 'L' rara
+    Historico h;
+
+    size_t *ks = malloc(consultas * sizeof(size_t));
+    if (ks == NULL) {
+        return 1;
+    }
+    srand(42);
+    for (int i = 0; i < consultas; i++) {
+        ks[i] = (size_t)rand() * 7919u + (size_t)rand();
+    }
+
+    printf("===== Benchmark Historico =====\n");
+    for (int i = 0; i < 2; i++) {
+        size_t lances = tamanhos[i];
+        if (!preencher(&h, lances, raridades[i])) {
+            return 1;
+        }
+        printf("%zu lances, 'L' com frequencia 1/%d:\n", lances, raridades[i]);
+        printf("  memoria %zu bytes (%.3f bytes/lance); vetor de Peca: %zu bytes\n",
+               memoriaHistorico(&h), (double)memoriaHistorico(&h) / lances, lances * 8);
+        medir(&h, "IOTL", 4, ks, consultas);
+        medir(&h, "T", 1, ks, consultas);
+        medir(&h, "L", 1, ks, consultas);
+        liberarHistorico(&h);
+    }
+
+    free(ks);
+    return 0;
+}
+#endif
@@ -0,0 +1,60 @@
+#ifndef HISTORICO_H
+#define HISTORICO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// -------------------------------------------------------
+// Histórico compacto das peças jogadas (2 bits por peça)
+// -------------------------------------------------------
+// Cada peça jogada ocupa 2 bits ('I' = 0, 'O' = 1, 'T' = 2, 'L' = 3),
+// 32 peças por palavra de 64 bits. Índices pequenos por bloco permitem
+// responder com popcount:
+//   rank(tipo, k)   -> quantas peças "tipo" foram jogadas antes do lance k
+//   select(tipo, j) -> em qual lance foi jogada a j-ésima peça "tipo"
+
+#define HIST_TIPOS            4
+#define HIST_PECAS_PALAVRA    32
+#define HIST_PALAVRAS_BLOCO   4                                  // 128 peças
+#define HIST_PECAS_BLOCO      (HIST_PECAS_PALAVRA * HIST_PALAVRAS_BLOCO)
+#define HIST_PECAS_SUPER      65536                              // 512 blocos
+#define HIST_PASSO_AMOSTRA    256   // 1 amostra de select a cada 256 ocorrências
+#define HIST_SPAN_DENSO       8192  // trecho de 256 ocorrências com até 64 blocos
+
+// select em O(1): cada trecho de HIST_PASSO_AMOSTRA ocorrências de um
+// tipo é "denso" (cabe em HIST_SPAN_DENSO lances, busca em no máximo 64
+// blocos) ou "esparso" (as 256 posições ficam guardadas explicitamente,
+// no máximo 4 bytes a cada 32 lances). O trecho ainda incompleto fica em
+// spanAtual.
+
+typedef struct {
+    uint64_t *palavras;      // peças compactadas
+    uint32_t *superblocos;   // contagem acumulada por tipo até o superbloco
+    uint16_t *blocos;        // contagem por tipo desde o início do superbloco
+    uint32_t *amostras[HIST_TIPOS];  // bloco da ocorrência j * HIST_PASSO_AMOSTRA
+    int32_t *esparsos[HIST_TIPOS];   // por amostra: trecho em posicoes, ou -1 se denso
+    size_t capAmostras[HIST_TIPOS];
+    uint32_t *posicoes[HIST_TIPOS];  // posições dos trechos esparsos
+    size_t qtdPosicoes[HIST_TIPOS];
+    size_t capPosicoes[HIST_TIPOS];
+    uint32_t spanAtual[HIST_TIPOS][HIST_PASSO_AMOSTRA];  // trecho incompleto
+    size_t total[HIST_TIPOS];        // ocorrências de cada tipo
+    uint32_t noSuper[HIST_TIPOS];    // ocorrências no superbloco atual
+    size_t qtd;              // quantidade de peças registradas
+    size_t capacidade;       // capacidade em peças (múltiplo de HIST_PECAS_BLOCO)
+} Historico;
+
+void inicializarHistorico(Historico *h);
+void liberarHistorico(Historico *h);
+
+// Registra a peça jogada; retorna 0 se o tipo for inválido ou faltar memória.
+int registrarJogada(Historico *h, char nome);
+
+char pecaNoHistorico(const Historico *h, size_t k);
+size_t rankHistorico(const Historico *h, char nome, size_t k);
+long selectHistorico(const Historico *h, char nome, size_t j);  // -1 se não existe
+
+// Bytes usados pelas estruturas (capacidade alocada, não só o ocupado).
+size_t memoriaHistorico(const Historico *h);
+
+#endif
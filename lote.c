@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "lote.h"
+
+#define MASCARA_FILA   0xFFFFFFFFFFull  // bytes 0..4
+#define MASCARA_PILHA  0xFFFFFFull      // 3 bytes (após o deslocamento de 40)
+#define DESLOC_PILHA   40
+
+// -------------------------------------------------------
+// Lote em layout SoA: arrays logo após o cabeçalho, no mesmo bloco
+// -------------------------------------------------------
+struct LoteSessoes {
+    int n;
+    uint64_t *estado;  // fila + pilha compactadas (ver lote.h)
+    uint32_t *rng;     // estado xorshift32 de cada sessão
+};
+
+// -------------------------------------------------------
+// Gerador por sessão (xorshift32): sem estado global como rand()
+// -------------------------------------------------------
+static uint32_t avancarRng(uint32_t r) {
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    return r;
+}
+
+static uint32_t sementeDaSessao(uint32_t semente, int i) {
+    // mistura simples para sessões vizinhas não começarem correlacionadas
+    uint32_t x = semente ^ (0x9E3779B9u * (uint32_t)(i + 1));
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    return x ? x : 1u;  // xorshift não pode partir do zero
+}
+
+// Código 1..4 a partir dos 2 bits mais altos do gerador
+static uint64_t codigoDoRng(uint32_t r) {
+    return 1u + (r >> 30);
+}
+
+// Inverte a ordem dos 3 bytes baixos
+static uint64_t inverter3(uint64_t x) {
+    return ((x & 0xFFu) << 16) | (x & 0xFF00u) | ((x >> 16) & 0xFFu);
+}
+
+// -------------------------------------------------------
+// Criação / destruição
+// -------------------------------------------------------
+LoteSessoes *criarLote(int n, uint32_t semente) {
+    if (n <= 0) {
+        return NULL;
+    }
+
+    size_t cab = (sizeof(LoteSessoes) + 63) & ~(size_t)63;
+    size_t bytesEstado = (size_t)n * sizeof(uint64_t);
+    size_t bytesRng = (size_t)n * sizeof(uint32_t);
+
+    unsigned char *bloco = malloc(cab + bytesEstado + bytesRng);
+    if (bloco == NULL) {
+        return NULL;
+    }
+
+    LoteSessoes *l = (LoteSessoes *)bloco;
+    l->n = n;
+    l->estado = (uint64_t *)(bloco + cab);
+    l->rng = (uint32_t *)(bloco + cab + bytesEstado);
+
+    for (int i = 0; i < n; i++) {
+        reiniciarSessaoLote(l, i, semente);
+    }
+    return l;
+}
+
+void destruirLote(LoteSessoes *l) {
+    free(l);
+}
+
+int tamanhoLote(const LoteSessoes *l) {
+    return l->n;
+}
+
+// Fila cheia com 5 peças novas e pilha vazia, como no início de mestre.c
+void reiniciarSessaoLote(LoteSessoes *l, int i, uint32_t semente) {
+    if (i < 0 || i >= l->n) {
+        return;
+    }
+    uint32_t r = sementeDaSessao(semente, i);
+    uint64_t s = 0;
+    for (int k = 0; k < LOTE_TAM_FILA; k++) {
+        r = avancarRng(r);
+        s |= codigoDoRng(r) << (8 * k);
+    }
+    l->estado[i] = s;
+    l->rng[i] = r;
+}
+
+// -------------------------------------------------------
+// Passo vetorizado
+// -------------------------------------------------------
+// O corpo do laço não tem desvios: todas as ações são calculadas e a
+// certa é escolhida por máscaras, o que permite ao compilador
+// vetorizar o laço (-O3, de preferência com -march=native).
+// A semântica segue o main() de mestre.c:
+//  - a fila está sempre cheia, então "usar reservada" (3) não repõe a
+//    fila (o enfileirar de mestre.c falha em silêncio);
+//  - a troca múltipla (5) exige a pilha cheia.
+static int aplicarAcoes(int n, uint64_t *restrict estado, uint32_t *restrict rng,
+                        const uint8_t *restrict acoes, uint64_t *restrict obs,
+                        uint8_t *restrict validos) {
+    int totalValidas = 0;
+
+    for (int i = 0; i < n; i++) {
+        const uint64_t a = acoes[i];
+        const uint64_t s = estado[i];
+        const uint32_t r = rng[i];
+
+        const uint64_t q = s & MASCARA_FILA;
+        const uint64_t st = s >> DESLOC_PILHA;
+        const uint64_t qtd = (uint64_t)((st & 0xFFu) != 0)
+                           + (uint64_t)(((st >> 8) & 0xFFu) != 0)
+                           + (uint64_t)(((st >> 16) & 0xFFu) != 0);
+
+        // máscaras "a pilha tem k peças"; substituem deslocamentos
+        // variáveis, que impediriam a vetorização
+        const uint64_t m0 = 0 - (uint64_t)(qtd == 0);
+        const uint64_t m1 = 0 - (uint64_t)(qtd == 1);
+        const uint64_t m2 = 0 - (uint64_t)(qtd == 2);
+        const uint64_t m3 = 0 - (uint64_t)(qtd == 3);
+
+        const uint32_t rNovo = avancarRng(r);
+        const uint64_t nova = codigoDoRng(rNovo);
+
+        const uint64_t frente = q & 0xFFu;
+        const uint64_t mascTopo = (0xFFull & m1) | (0xFF00ull & m2) | (0xFF0000ull & m3);
+        const uint64_t frenteNoTopo = (frente & m1) | ((frente << 8) & m2) | ((frente << 16) & m3);
+        const uint64_t frenteNoLivre = (frente & m0) | ((frente << 8) & m1) | ((frente << 16) & m2);
+        const uint64_t topo = (st & m1 & 0xFFu) | ((st >> 8) & m2 & 0xFFu) | ((st >> 16) & m3 & 0xFFu);
+        const uint64_t semTopo = st & ~mascTopo;
+        const uint64_t qAvanca = (q >> 8) | (nova << 32);
+
+        const uint64_t s1 = qAvanca | (st << DESLOC_PILHA);
+        const uint64_t s2 = qAvanca
+                          | (((st | frenteNoLivre) & MASCARA_PILHA) << DESLOC_PILHA);
+        const uint64_t s3 = q | ((semTopo & MASCARA_PILHA) << DESLOC_PILHA);
+        const uint64_t s4 = (q & ~0xFFull) | topo
+                          | (((semTopo | frenteNoTopo) & MASCARA_PILHA) << DESLOC_PILHA);
+        const uint64_t s5 = (q & ~0xFFFFFFull) | inverter3(st)
+                          | (inverter3(q) << DESLOC_PILHA);
+
+        const uint64_t e1 = (a == 1);
+        const uint64_t e2 = (a == 2) & (qtd < LOTE_TAM_PILHA);
+        const uint64_t e3 = (a == 3) & (qtd > 0);
+        const uint64_t e4 = (a == 4) & (qtd > 0);
+        const uint64_t e5 = (a == 5) & (qtd == LOTE_TAM_PILHA);
+        const uint64_t valido = (a == 0) | e1 | e2 | e3 | e4 | e5;
+        const uint64_t gera = e1 | e2 | e3;
+        const uint64_t mantem = 1 ^ (e1 | e2 | e3 | e4 | e5);
+
+        const uint64_t novoEstado = (s1 & (0 - e1)) | (s2 & (0 - e2))
+                                  | (s3 & (0 - e3)) | (s4 & (0 - e4))
+                                  | (s5 & (0 - e5)) | (s & (0 - mantem));
+
+        estado[i] = novoEstado;
+        rng[i] = gera ? rNovo : r;
+        obs[i] = novoEstado;
+        validos[i] = (uint8_t)valido;
+        totalValidas += (int)valido;
+    }
+    return totalValidas;
+}
+
+int passoLote(LoteSessoes *l, const uint8_t *acoes,
+              uint64_t *obs, uint8_t *validos) {
+    return aplicarAcoes(l->n, l->estado, l->rng, acoes, obs, validos);
+}
+
+char nomeDoCodigo(uint8_t codigo) {
+    static const char nomes[] = {'\0', 'I', 'O', 'T', 'L'};
+    return (codigo <= 4) ? nomes[codigo] : '?';
+}
+
+// -------------------------------------------------------
+// Benchmark (gcc -O3 -march=native -DLOTE_BENCH lote.c -o lote_bench)
+// -------------------------------------------------------
+#ifdef LOTE_BENCH
+#include <time.h>
+
+static double agoraSegundos(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    const int tamanhos[] = {1, 64, 4096};
+    const long passosSessao = 1L << 24;  // passos de sessão por medição
+    const int variacoes = 16;            // vetores de ações pré-sorteados
+
+    printf("===== Benchmark passoLote =====\n");
+    for (size_t t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]); t++) {
+        int n = tamanhos[t];
+        LoteSessoes *l = criarLote(n, 12345u);
+        uint8_t *acoes = malloc((size_t)n * variacoes);
+        uint64_t *obs = malloc((size_t)n * sizeof(uint64_t));
+        uint8_t *validos = malloc((size_t)n);
+        if (l == NULL || acoes == NULL || obs == NULL || validos == NULL) {
+            printf("[ERRO] Sem memoria para N=%d\n", n);
+            return 1;
+        }
+
+        uint32_t r = 777u;
+        for (int k = 0; k < n * variacoes; k++) {
+            r = avancarRng(r);
+            acoes[k] = (uint8_t)(1 + r % 5);
+        }
+
+        long chamadas = passosSessao / n;
+        long validas = 0;
+        double t0 = agoraSegundos();
+        for (long c = 0; c < chamadas; c++) {
+            validas += passoLote(l, acoes + (size_t)(c % variacoes) * n, obs, validos);
+        }
+        double dt = agoraSegundos() - t0;
+
+        printf("N=%-5d chamadas/s=%12.0f  passos de sessao/s=%13.0f  (validas %.1f%%)\n",
+               n, chamadas / dt, chamadas * (double)n / dt,
+               100.0 * validas / ((double)chamadas * n));
+
+        free(validos);
+        free(obs);
+        free(acoes);
+        destruirLote(l);
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,52 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <stdint.h>
+
+// -------------------------------------------------------
+// Lote de N sessões do nível Mestre (API para bots)
+// -------------------------------------------------------
+// Cada sessão é guardada como uma única palavra de 64 bits:
+//   bytes 0..4 -> fila (frente -> fim)
+//   bytes 5..7 -> pilha (base -> topo), 0 = posição vazia
+// Cada byte guarda o código da peça: 1 = 'I', 2 = 'O', 3 = 'T', 4 = 'L'.
+// Esses códigos são próprios do lote (0 fica livre para "vazio") e não
+// são os mesmos do historico.h, que usa 'I' = 0 ... 'L' = 3.
+// Essa mesma palavra é a observação devolvida por passoLote().
+//
+// As ações usam os mesmos códigos do menu de mestre.c:
+//   1 - jogar peça da frente da fila
+//   2 - reservar peça (fila -> pilha)
+//   3 - usar peça reservada (topo da pilha)
+//   4 - trocar frente da fila com topo da pilha
+//   5 - trocar as 3 primeiras da fila com as 3 da pilha
+//   0 - sair (não altera o estado; use reiniciarSessaoLote)
+// Qualquer outro código é inválido e não altera a sessão.
+
+#define LOTE_TAM_FILA   5
+#define LOTE_TAM_PILHA  3
+
+typedef struct LoteSessoes LoteSessoes;
+
+// Aloca (em um único bloco contíguo) e inicializa n sessões.
+// Retorna NULL se n <= 0 ou se faltar memória.
+LoteSessoes *criarLote(int n, uint32_t semente);
+void destruirLote(LoteSessoes *l);
+
+int tamanhoLote(const LoteSessoes *l);
+void reiniciarSessaoLote(LoteSessoes *l, int i, uint32_t semente);
+
+// Aplica acoes[i] à sessão i para todo i em [0, n).
+// obs[i] recebe o estado compactado e validos[i] recebe 1 se a ação
+// foi aceita ou 0 se foi rejeitada (ex.: reservar com a pilha cheia).
+// acoes, obs e validos devem ter n posições e não podem se sobrepor.
+// Não faz nenhuma alocação.
+// Retorna a quantidade de ações válidas.
+int passoLote(LoteSessoes *l, const uint8_t *acoes,
+              uint64_t *obs, uint8_t *validos);
+
+// Converte o código de um byte da observação em letra: '\0' para 0
+// (posição vazia) e '?' para códigos acima de 4.
+char nomeDoCodigo(uint8_t codigo);
+
+#endif
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include "comandos.h"
+#include "historico.h"
+
 #define TAM_FILA   5   // capacidade da fila
 #define TAM_PILHA  3   // capacidade da pilha
 
@@ -53,6 +56,8 @@ Peca gerarPeca(int *proxId);
 void trocarPecaAtual(Fila *f, Pilha *p);
 void trocaMultipla(Fila *f, Pilha *p);
 
+void executarOpcao(int opcao, Fila *fila, Pilha *pilha, Historico *historico, int *proxId);
+
 // -------------------------------------------------------
 // Implementação da fila circular
 // -------------------------------------------------------
@@ -229,20 +234,92 @@ void trocaMultipla(Fila *f, Pilha *p) {
     printf("\nTroca multipla realizada entre as 3 primeiras pecas da fila e as 3 da pilha.\n");
 }
 
+// -------------------------------------------------------
+// Executa uma opção do menu
+// -------------------------------------------------------
+void executarOpcao(int opcao, Fila *fila, Pilha *pilha, Historico *historico, int *proxId) {
+    Peca p;
+
+    switch (opcao) {
+        case 1: // Jogar peça da fila
+            if (desenfileirar(fila, &p)) {
+                printf("\nPeca jogada: [%c %d]\n", p.nome, p.id);
+                if (!registrarJogada(historico, p.nome)) {
+                    printf("\n[ERRO] Memoria insuficiente! Jogada nao registrada no historico.\n");
+                }
+                // gera nova para manter a fila cheia
+                Peca nova = gerarPeca(proxId);
+                enfileirar(fila, nova);
+            }
+            break;
+
+        case 2: // Reservar peça (fila -> pilha)
+            if (pilhaCheia(pilha)) {
+                printf("\n[ERRO] Pilha cheia! Nao e possivel reservar.\n");
+            } else if (desenfileirar(fila, &p)) {
+                if (empilhar(pilha, p)) {
+                    printf("\nPeca [%c %d] movida da fila para a pilha de reserva.\n",
+                           p.nome, p.id);
+                    // repor fila
+                    Peca nova = gerarPeca(proxId);
+                    enfileirar(fila, nova);
+                }
+            }
+            break;
+
+        case 3: // Usar peça reservada (topo da pilha)
+            if (desempilhar(pilha, &p)) {
+                printf("\nPeca reservada usada: [%c %d]\n", p.nome, p.id);
+                if (!registrarJogada(historico, p.nome)) {
+                    printf("\n[ERRO] Memoria insuficiente! Jogada nao registrada no historico.\n");
+                }
+                // gerar nova apenas para a fila (a peça usada sai do jogo)
+                Peca nova = gerarPeca(proxId);
+                enfileirar(fila, nova);
+            }
+            break;
+
+        case 4: // Trocar peça atual (frente da fila <-> topo da pilha)
+            trocarPecaAtual(fila, pilha);
+            break;
+
+        case 5: // Troca múltipla (3 primeiras da fila <-> 3 da pilha)
+            trocaMultipla(fila, pilha);
+            break;
+
+        case 0:
+            printf("\nPecas jogadas: %zu (I: %zu, O: %zu, T: %zu, L: %zu)\n",
+                   historico->qtd,
+                   rankHistorico(historico, 'I', historico->qtd),
+                   rankHistorico(historico, 'O', historico->qtd),
+                   rankHistorico(historico, 'T', historico->qtd),
+                   rankHistorico(historico, 'L', historico->qtd));
+            printf("\nEncerrando simulacao do nivel Mestre. GG!\n");
+            break;
+
+        default:
+            printf("\nOpcao invalida. Tente novamente.\n");
+    }
+}
+
 // -------------------------------------------------------
 // Função principal - Nível Mestre
 // -------------------------------------------------------
 int main() {
     Fila fila;
     Pilha pilha;
-    int opcao;
+    int opcao = -1;
     int proxId = 0;
-    Peca p;
+    Historico historico;  // sequência compacta das peças jogadas
+    static LeitorComandos leitor;  // buffer grande: fora da pilha de execução
+    Comando comandos[MAX_COMANDOS_LINHA];
 
     srand((unsigned)time(NULL));
 
     inicializarFila(&fila);
     inicializarPilha(&pilha);
+    inicializarHistorico(&historico);
+    iniciarLeitor(&leitor, stdin);
 
     // Preenche a fila com TAM_FILA peças iniciais
     for (int i = 0; i < TAM_FILA; i++) {
@@ -253,6 +330,7 @@ int main() {
     printf("===== Nível Mestre - Tetris Stack (Fila + Pilha + Trocas) =====\n");
 
     do {
+        // estado e menu são exibidos uma vez por linha de comandos
         printf("\n=== ESTADO ATUAL ===\n");
         exibirFila(&fila);
         exibirPilha(&pilha);
@@ -264,59 +342,29 @@ int main() {
         printf("4 - Trocar peca da frente da fila com o topo da pilha\n");
         printf("5 - Trocar os 3 primeiros da fila com as 3 pecas da pilha\n");
         printf("0 - Sair\n");
+        printf("(varias opcoes por linha; NxK repete N K vezes, ex.: 1 1 2 5x3)\n");
         printf("Opcao escolhida: ");
-        scanf("%d", &opcao);
-
-        switch (opcao) {
-            case 1: // Jogar peça da fila
-                if (desenfileirar(&fila, &p)) {
-                    printf("\nPeca jogada: [%c %d]\n", p.nome, p.id);
-                    // gera nova para manter a fila cheia
-                    Peca nova = gerarPeca(&proxId);
-                    enfileirar(&fila, nova);
-                }
-                break;
-
-            case 2: // Reservar peça (fila -> pilha)
-                if (pilhaCheia(&pilha)) {
-                    printf("\n[ERRO] Pilha cheia! Nao e possivel reservar.\n");
-                } else if (desenfileirar(&fila, &p)) {
-                    if (empilhar(&pilha, p)) {
-                        printf("\nPeca [%c %d] movida da fila para a pilha de reserva.\n",
-                               p.nome, p.id);
-                        // repor fila
-                        Peca nova = gerarPeca(&proxId);
-                        enfileirar(&fila, nova);
-                    }
-                }
-                break;
-
-            case 3: // Usar peça reservada (topo da pilha)
-                if (desempilhar(&pilha, &p)) {
-                    printf("\nPeca reservada usada: [%c %d]\n", p.nome, p.id);
-                    // gerar nova apenas para a fila (a peça usada sai do jogo)
-                    Peca nova = gerarPeca(&proxId);
-                    enfileirar(&fila, nova);
-                }
-                break;
-
-            case 4: // Trocar peça atual (frente da fila <-> topo da pilha)
-                trocarPecaAtual(&fila, &pilha);
-                break;
-
-            case 5: // Troca múltipla (3 primeiras da fila <-> 3 da pilha)
-                trocaMultipla(&fila, &pilha);
-                break;
 
-            case 0:
-                printf("\nEncerrando simulacao do nivel Mestre. GG!\n");
-                break;
+        int qtd = lerComandos(&leitor, comandos, MAX_COMANDOS_LINHA);
+        if (qtd == LEITURA_FIM) {
+            executarOpcao(0, &fila, &pilha, &historico, &proxId);
+            break;
+        }
+        if (qtd == LEITURA_ERRO) {
+            printf("\n[ERRO] Entrada invalida: '%s'. Nenhuma acao executada.\n",
+                   leitor.tokenErro);
+            continue;
+        }
 
-            default:
-                printf("\nOpcao invalida. Tente novamente.\n");
+        for (int i = 0; i < qtd && opcao != 0; i++) {
+            for (int r = 0; r < comandos[i].repeticoes && opcao != 0; r++) {
+                opcao = comandos[i].acao;
+                executarOpcao(opcao, &fila, &pilha, &historico, &proxId);
+            }
         }
 
     } while (opcao != 0);
 
+    liberarHistorico(&historico);
     return 0;
 }